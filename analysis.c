@@ -0,0 +1,156 @@
+#include "analysis.h"
+#include "connectfour.h"
+#include "threadpool.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#define ANALYSIS_SLOTS_PER_THREAD 16 // In-flight positions per worker; bounds memory on huge inputs
+#define ANALYSIS_LINE_MAX 128        // A full game is ROWS * COLS moves, so this leaves ample slack
+
+typedef struct BatchContext BatchContext;
+
+// One in-flight position. Slots form a ring that the reader refills once the
+// oldest result has been written, so output stays in input order.
+typedef struct {
+    int board[ROWS][COLS];
+    int player;
+    MCTSResult result;
+    bool done;
+    BatchContext* ctx;
+} AnalysisSlot;
+
+struct BatchContext {
+    const MCTSOptions* options;
+    pthread_mutex_t lock;
+    pthread_cond_t slot_done;
+};
+
+
+static void analyze_slot(void* arg) {
+    AnalysisSlot* slot = (AnalysisSlot*)arg;
+    BatchContext* ctx = slot->ctx;
+
+    mcts_analyze(slot->board, slot->player, ctx->options, &slot->result);
+
+    pthread_mutex_lock(&ctx->lock);
+    slot->done = true;
+    pthread_cond_broadcast(&ctx->slot_done);
+    pthread_mutex_unlock(&ctx->lock);
+}
+
+// Waits for the slot's result and writes it. Returns false once out has hit a write error.
+static bool write_slot(FILE* out, BatchContext* ctx, AnalysisSlot* slot) {
+    pthread_mutex_lock(&ctx->lock);
+    while (!slot->done) {
+        pthread_cond_wait(&ctx->slot_done, &ctx->lock);
+    }
+    pthread_mutex_unlock(&ctx->lock);
+
+    fprintf(out, "%d %.4f", slot->result.best_move, slot->result.value);
+    for (int c = 0; c < COLS; c++) {
+        fprintf(out, " %d", slot->result.visits[c]);
+    }
+    fprintf(out, "\n");
+    return !ferror(out);
+}
+
+// Reads one line into buffer. Returns false at EOF or on a read error (tell them
+// apart with ferror); sets *too_long (and drops the rest of the line) if it did not fit.
+static bool read_line(FILE* in, char* buffer, size_t size, bool* too_long) {
+    *too_long = false;
+    if (fgets(buffer, (int)size, in) == NULL) {
+        return false;
+    }
+    if (strchr(buffer, '\n') == NULL && !feof(in)) {
+        *too_long = true;
+        int ch;
+        while ((ch = fgetc(in)) != EOF && ch != '\n') {
+            // Discard the remainder of an over-long line
+        }
+    }
+    return true;
+}
+
+
+long analyze_stream(FILE* in, FILE* out, int num_threads, const MCTSOptions* options) {
+    if (num_threads < 1) num_threads = 1;
+
+    ThreadPool* pool = threadpool_create(num_threads);
+    if (!pool) return -1;
+
+    int num_slots = num_threads * ANALYSIS_SLOTS_PER_THREAD;
+    AnalysisSlot* slots = (AnalysisSlot*)calloc(num_slots, sizeof(AnalysisSlot));
+    if (!slots) {
+        perror("Failed to allocate analysis slots");
+        threadpool_destroy(pool);
+        return -1;
+    }
+
+    BatchContext ctx;
+    ctx.options = options;
+    pthread_mutex_init(&ctx.lock, NULL);
+    pthread_cond_init(&ctx.slot_done, NULL);
+
+    char line[ANALYSIS_LINE_MAX];
+    bool too_long;
+    long num_read = 0;
+    long num_written = 0;
+    bool write_failed = false;
+
+    while (read_line(in, line, sizeof(line), &too_long)) {
+        // Ring is full: the oldest position must be written before its slot is reused
+        if (num_read - num_written == num_slots) {
+            if (!write_slot(out, &ctx, &slots[num_written % num_slots])) {
+                write_failed = true;
+                break; // No point analyzing positions whose results cannot be written
+            }
+            num_written++;
+        }
+
+        AnalysisSlot* slot = &slots[num_read % num_slots];
+        num_read++;
+        slot->ctx = &ctx;
+        slot->done = false;
+        mcts_clear_result(&slot->result);
+
+        if (too_long || !parse_position(line, slot->board, &slot->player)) {
+            fprintf(stderr, "Warning: Line %ld is not a valid position, skipping.\n", num_read);
+            slot->done = true;
+        } else if (check_game_over(slot->board) != -1) {
+            fprintf(stderr, "Warning: Line %ld is a finished game, nothing to analyze.\n", num_read);
+            slot->done = true;
+        } else if (!threadpool_submit(pool, analyze_slot, slot)) {
+            fprintf(stderr, "Error: Could not queue line %ld for analysis.\n", num_read);
+            slot->done = true;
+        }
+    }
+
+    bool read_failed = !write_failed && ferror(in);
+    if (read_failed) {
+        perror("Error: Failed to read positions");
+    }
+
+    while (!write_failed && num_written < num_read) {
+        if (!write_slot(out, &ctx, &slots[num_written % num_slots])) {
+            write_failed = true;
+            break;
+        }
+        num_written++;
+    }
+    if (fflush(out) != 0) {
+        write_failed = true;
+    }
+    if (write_failed) {
+        fprintf(stderr, "Error: Failed to write analysis results.\n");
+    }
+
+    // Waits for any still-running searches before their slots are freed
+    threadpool_destroy(pool);
+    pthread_cond_destroy(&ctx.slot_done);
+    pthread_mutex_destroy(&ctx.lock);
+    free(slots);
+
+    return (read_failed || write_failed) ? -1 : num_written;
+}
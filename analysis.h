@@ -0,0 +1,20 @@
+#ifndef ANALYSIS_H
+#define ANALYSIS_H
+
+#include <stdio.h>
+#include "mcts.h"
+
+// --- Batch Position Analysis ---
+// Reads one position per line from `in` (a move string, see parse_position; an
+// empty line is the starting position), searches them concurrently on a
+// work-stealing thread pool and writes one line per position to `out`, in input
+// order:
+//
+//     <best_move> <value> <visits col 0> ... <visits col COLS-1>
+//
+// Invalid or finished positions produce best_move -1, value 0 and zero visits,
+// with a warning on stderr. Returns the number of positions written, or -1 if
+// the thread pool could not be created or reading `in` / writing `out` failed.
+long analyze_stream(FILE* in, FILE* out, int num_threads, const MCTSOptions* options);
+
+#endif // ANALYSIS_H
@@ -0,0 +1,241 @@
+#include "bench.h"
+#include "connectfour.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+#define BENCH_POSITIONS 64           // Sample positions shared by every measurement
+#define BENCH_MAX_OPENING_MOVES 16   // Sample positions are random openings of up to this many moves
+#define BENCH_SECONDS 1.0            // CPU time spent measuring each rate
+#define BENCH_CALIBRATION_ITERATIONS 1000 // Search size used to measure MCTS iterations/sec
+#define BENCH_SEED 12345u            // Fixed so every policy sees the same positions
+#define BENCH_NUM_POLICIES 3
+
+static const PlayoutPolicy bench_policies[BENCH_NUM_POLICIES] = {
+    PLAYOUT_RANDOM, PLAYOUT_BITBOARD_RANDOM, PLAYOUT_TACTICAL
+};
+static const char* const bench_policy_names[BENCH_NUM_POLICIES] = {
+    "random (int board)", "random (bitboard)", "tactical (bitboard)"
+};
+
+typedef struct {
+    int board[ROWS][COLS];
+    int player;
+} BenchPosition;
+
+static double cpu_seconds_since(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+// Fills positions with random non-terminal openings
+static void make_positions(BenchPosition positions[BENCH_POSITIONS]) {
+    mcts_seed(BENCH_SEED);
+    int made = 0;
+    while (made < BENCH_POSITIONS) {
+        BenchPosition* pos = &positions[made];
+        init_board(pos->board);
+        pos->player = PLAYER1;
+        int num_moves = mcts_rand() % (BENCH_MAX_OPENING_MOVES + 1);
+        for (int i = 0; i < num_moves; i++) {
+            int col = mcts_rand() % COLS;
+            if (!is_valid_location(pos->board, col)) continue;
+            drop_piece(pos->board, get_next_open_row(pos->board, col), col, pos->player);
+            pos->player = (pos->player == PLAYER1) ? PLAYER2 : PLAYER1;
+        }
+        if (check_game_over(pos->board) == -1) {
+            made++;
+        }
+    }
+}
+
+// Playouts per CPU-second from the sample positions
+static double measure_playout_rate(BenchPosition positions[BENCH_POSITIONS], PlayoutPolicy policy) {
+    MCTSNode* nodes[BENCH_POSITIONS];
+    for (int i = 0; i < BENCH_POSITIONS; i++) {
+        nodes[i] = create_node(NULL, -1, positions[i].board, positions[i].player);
+        if (!nodes[i]) {
+            for (int j = 0; j < i; j++) free_node(nodes[j]);
+            return 0.0;
+        }
+    }
+
+    long playouts = 0;
+    clock_t start = clock();
+    double elapsed;
+    do {
+        // Check the clock once per sweep; a sweep is far shorter than BENCH_SECONDS
+        for (int i = 0; i < BENCH_POSITIONS; i++) {
+            switch (policy) {
+                case PLAYOUT_BITBOARD_RANDOM:
+                    simulate_bitboard_random_playout(nodes[i], NULL);
+                    break;
+                case PLAYOUT_TACTICAL:
+                    simulate_tactical_playout(nodes[i], NULL);
+                    break;
+                default:
+                    simulate_random_playout(nodes[i], NULL);
+                    break;
+            }
+        }
+        playouts += BENCH_POSITIONS;
+        elapsed = cpu_seconds_since(start);
+    } while (elapsed < BENCH_SECONDS);
+
+    for (int i = 0; i < BENCH_POSITIONS; i++) {
+        free_node(nodes[i]);
+    }
+    return playouts / elapsed;
+}
+
+// Full MCTS iterations (select/expand/simulate/backpropagate) per CPU-second
+static double measure_iteration_rate(BenchPosition positions[BENCH_POSITIONS], const MCTSOptions* options) {
+    MCTSOptions calibration = *options;
+    calibration.iterations = BENCH_CALIBRATION_ITERATIONS;
+
+    long iterations = 0;
+    clock_t start = clock();
+    double elapsed;
+    int i = 0;
+    do {
+        mcts_analyze(positions[i].board, positions[i].player, &calibration, NULL);
+        iterations += calibration.iterations;
+        i = (i + 1) % BENCH_POSITIONS;
+        elapsed = cpu_seconds_since(start);
+    } while (elapsed < BENCH_SECONDS);
+
+    return iterations / elapsed;
+}
+
+// Outcome of a match between the tactical engine and its control
+typedef struct {
+    int tactical_wins;
+    int control_wins;
+    int draws;
+    double cpu_seconds[2]; // Search time spent by [tactical, control]
+    int moves[2];          // Moves made by [tactical, control]
+} MatchResult;
+
+// Plays one game; engines[0] moves first. Returns 0 or 1 for the winning engine, -1 for a
+// draw. Adds each engine's search CPU time and move count to cpu_seconds[] / moves[].
+static int play_game(const MCTSOptions* engines[2], double cpu_seconds[2], int moves[2]) {
+    int board[ROWS][COLS];
+    init_board(board);
+    int player = PLAYER1;
+
+    int result;
+    while ((result = check_game_over(board)) == -1) {
+        int index = (player == PLAYER1) ? 0 : 1;
+        clock_t start = clock();
+        int col = mcts_analyze(board, player, engines[index], NULL);
+        cpu_seconds[index] += cpu_seconds_since(start);
+        moves[index]++;
+        if (col == -1 || !is_valid_location(board, col)) {
+            fprintf(stderr, "Error: Engine returned an invalid move during benchmark.\n");
+            return -1;
+        }
+        drop_piece(board, get_next_open_row(board, col), col, player);
+        player = (player == PLAYER1) ? PLAYER2 : PLAYER1;
+    }
+
+    if (result == 0) return -1;
+    return result == PLAYER1 ? 0 : 1;
+}
+
+// Plays num_games games, alternating which engine moves first
+static MatchResult play_match(const MCTSOptions* tactical, const MCTSOptions* control, int num_games) {
+    MatchResult match = { 0, 0, 0, { 0.0, 0.0 }, { 0, 0 } };
+    for (int g = 0; g < num_games; g++) {
+        bool tactical_first = (g % 2 == 0);
+        const MCTSOptions* engines[2];
+        engines[0] = tactical_first ? tactical : control;
+        engines[1] = tactical_first ? control : tactical;
+
+        // Per-game stats are indexed by seat; fold them back to [tactical, control]
+        double cpu_seconds[2] = { 0.0, 0.0 };
+        int moves[2] = { 0, 0 };
+        int winner = play_game(engines, cpu_seconds, moves);
+        int t = tactical_first ? 0 : 1;
+        match.cpu_seconds[0] += cpu_seconds[t];
+        match.cpu_seconds[1] += cpu_seconds[1 - t];
+        match.moves[0] += moves[t];
+        match.moves[1] += moves[1 - t];
+
+        if (winner == -1) {
+            match.draws++;
+        } else if (winner == t) {
+            match.tactical_wins++;
+        } else {
+            match.control_wins++;
+        }
+    }
+    return match;
+}
+
+// Prints the result with the tactical score and its 95% confidence interval
+// (normal approximation over per-game scores of 1, 0.5 and 0).
+static void print_match(FILE* out, const MatchResult* match) {
+    int n = match->tactical_wins + match->control_wins + match->draws;
+    double score = (match->tactical_wins + 0.5 * match->draws) / n;
+    double mean_square = (match->tactical_wins + 0.25 * match->draws) / n;
+    double variance = mean_square - score * score;
+    double half_width = (n > 1) ? 1.96 * sqrt(variance / (n - 1)) : 1.0;
+
+    fprintf(out, "tactical %d - random %d - draws %d: tactical score %.1f%% +/- %.1f%% (95%% CI)\n",
+            match->tactical_wins, match->control_wins, match->draws,
+            100.0 * score, 100.0 * half_width);
+    fprintf(out, "measured CPU per move: tactical %.1f ms, random %.1f ms\n",
+            match->moves[0] ? 1000.0 * match->cpu_seconds[0] / match->moves[0] : 0.0,
+            match->moves[1] ? 1000.0 * match->cpu_seconds[1] / match->moves[1] : 0.0);
+}
+
+
+void run_playout_benchmark(FILE* out, const MCTSOptions* base, int num_games, double move_seconds) {
+    BenchPosition positions[BENCH_POSITIONS];
+    make_positions(positions);
+
+    double playout_rates[BENCH_NUM_POLICIES];
+    double iteration_rates[BENCH_NUM_POLICIES];
+    for (int i = 0; i < BENCH_NUM_POLICIES; i++) {
+        MCTSOptions engine = *base;
+        engine.playout_policy = bench_policies[i];
+        playout_rates[i] = measure_playout_rate(positions, bench_policies[i]);
+        iteration_rates[i] = measure_iteration_rate(positions, &engine);
+    }
+
+    fprintf(out, "Playout policy benchmark (%d sample positions%s)\n",
+            BENCH_POSITIONS, base->use_rave ? ", RAVE" : "");
+    fprintf(out, "%-20s %14s %16s\n", "policy", "playouts/sec", "iterations/sec");
+    for (int i = 0; i < BENCH_NUM_POLICIES; i++) {
+        fprintf(out, "%-20s %14.0f %16.0f\n", bench_policy_names[i], playout_rates[i], iteration_rates[i]);
+    }
+
+    if (num_games <= 0) return;
+
+    // Both sides play on bitboards, so the matches isolate the win/block rule
+    MCTSOptions control_engine = *base;
+    control_engine.playout_policy = PLAYOUT_BITBOARD_RANDOM;
+    MCTSOptions tactical_engine = *base;
+    tactical_engine.playout_policy = PLAYOUT_TACTICAL;
+
+    int control_budget = (int)(iteration_rates[1] * move_seconds);
+    int tactical_budget = (int)(iteration_rates[2] * move_seconds);
+    if (control_budget < 1) control_budget = 1;
+    if (tactical_budget < 1) tactical_budget = 1;
+
+    // 1. Same iterations for both: playout quality alone
+    control_engine.iterations = control_budget;
+    tactical_engine.iterations = control_budget;
+    fprintf(out, "\nEqual iterations (%d it per move each), %d games\n", control_budget, num_games);
+    MatchResult match = play_match(&tactical_engine, &control_engine, num_games);
+    print_match(out, &match);
+
+    // 2. Iteration counts derived from the calibrated rates for a nominal CPU budget.
+    // Per-iteration cost shifts with tree depth, so the measured CPU per move is reported too.
+    tactical_engine.iterations = tactical_budget;
+    fprintf(out, "\nEqual iterations derived from calibration for %.0f ms per move "
+            "(random %d it, tactical %d it), %d games\n",
+            1000.0 * move_seconds, control_budget, tactical_budget, num_games);
+    match = play_match(&tactical_engine, &control_engine, num_games);
+    print_match(out, &match);
+}
@@ -0,0 +1,24 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdio.h>
+#include "mcts.h"
+
+#define BENCH_DEFAULT_GAMES 100  // Games per strength match (about +/- 10% score at 95% confidence)
+#define BENCH_DEFAULT_MOVE_MS 20 // Nominal CPU milliseconds per move used to size searches
+
+// --- Playout Policy Benchmark ---
+// Compares playout policies on a fixed sample of positions:
+//   1. playouts and full MCTS iterations per CPU-second for the int-board random,
+//      bitboard random and bitboard tactical policies. The two bitboard policies
+//      differ only in move choice, so their ratio shows the cost of win/block
+//      detection. The int-board row shows what the representation change alone gains.
+//   2. tactical vs bitboard random, num_games self-play games (alternating colours)
+//      at equal iterations: the iterations the random side runs in move_seconds.
+//   3. the same match with iteration counts derived from each policy's calibrated
+//      rate for move_seconds. This is a fixed iteration count, not a time limit,
+//      so the CPU time actually measured per move is printed alongside.
+// base supplies the remaining search options (e.g. RAVE) for both sides.
+void run_playout_benchmark(FILE* out, const MCTSOptions* base, int num_games, double move_seconds);
+
+#endif // BENCH_H
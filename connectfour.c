@@ -155,3 +155,88 @@ int* get_valid_moves(int board[ROWS][COLS], int* num_moves) {
 
     return valid_moves;
 }
+
+
+bool parse_position(const char* moves, int board[ROWS][COLS], int* player_to_move) {
+    int player = PLAYER1;
+    bool game_ended = false;
+    bool moves_started = false;
+    bool moves_ended = false;
+    init_board(board);
+
+    for (const char* p = moves; *p != '\0'; p++) {
+        if (*p == '\n' || *p == '\r' || *p == ' ' || *p == '\t') {
+            // Leading/trailing whitespace from line-based input is fine, but a gap
+            // inside the move string is an error
+            moves_ended = moves_started;
+            continue;
+        }
+        int col = *p - '0';
+        if (moves_ended || game_ended || !is_valid_location(board, col)) {
+            return false;
+        }
+        moves_started = true;
+        drop_piece(board, get_next_open_row(board, col), col, player);
+        game_ended = check_win(board, player);
+        player = (player == PLAYER1) ? PLAYER2 : PLAYER1;
+    }
+
+    *player_to_move = player;
+    return true;
+}
+
+
+// --- Bitboards ---
+_Static_assert(COLS * (ROWS + 1) <= 64, "Bitboard must fit in 64 bits");
+_Static_assert(CONNECT_LEN == 4, "bitboard_winning_cells assumes lines of four");
+
+// Bottom cell of every column, and every playable cell (sentinel rows excluded)
+static uint64_t bottom_mask(void) {
+    uint64_t mask = 0;
+    for (int c = 0; c < COLS; c++) {
+        mask |= (uint64_t)1 << (c * (ROWS + 1));
+    }
+    return mask;
+}
+
+static uint64_t board_mask(void) {
+    return bottom_mask() * ((((uint64_t)1) << ROWS) - 1);
+}
+
+void board_to_bitboards(int board[ROWS][COLS], uint64_t pieces[2]) {
+    pieces[0] = 0;
+    pieces[1] = 0;
+    for (int r = 0; r < ROWS; r++) {
+        for (int c = 0; c < COLS; c++) {
+            if (board[r][c] == PLAYER1) pieces[0] |= BITBOARD_BIT(r, c);
+            if (board[r][c] == PLAYER2) pieces[1] |= BITBOARD_BIT(r, c);
+        }
+    }
+}
+
+uint64_t bitboard_playable(uint64_t occupied) {
+    // Adding the bottom row carries into the first empty cell of each column
+    return (occupied + bottom_mask()) & board_mask();
+}
+
+uint64_t bitboard_winning_cells(uint64_t own, uint64_t occupied) {
+    const int H = ROWS + 1;
+
+    // Vertical: three stacked pieces directly below
+    uint64_t r = (own << 1) & (own << 2) & (own << 3);
+
+    // Horizontal (H), and the two diagonals (H - 1 and H + 1): the empty cell may be
+    // at either end of the line or in one of the two inner positions
+    const int shifts[3] = { H, H - 1, H + 1 };
+    for (int i = 0; i < 3; i++) {
+        int d = shifts[i];
+        uint64_t p = (own << d) & (own << 2 * d);
+        r |= p & (own << 3 * d);
+        r |= p & (own >> d);
+        p = (own >> d) & (own >> 2 * d);
+        r |= p & (own >> 3 * d);
+        r |= p & (own << d);
+    }
+
+    return r & (board_mask() ^ occupied);
+}
@@ -3,6 +3,7 @@
 
 #include "defines.h"
 #include <stdbool.h>
+#include <stdint.h>
 
 // --- Function Declarations ---
 
@@ -22,4 +23,19 @@ int check_game_over(int board[ROWS][COLS]); // Returns winner (PLAYER1/PLAYER2),
 // Move generation
 int* get_valid_moves(int board[ROWS][COLS], int* num_moves); // Returns dynamically allocated array
 
+// Position parsing
+// Replays a move string of column digits ("0"-"6", PLAYER1 first) onto an empty board.
+// Leading and trailing whitespace is ignored. Returns false on bad characters (including
+// whitespace between moves), full columns, or moves after the game has ended.
+bool parse_position(const char* moves, int board[ROWS][COLS], int* player_to_move);
+
+// Bitboards
+// One bit per cell, column-major with ROWS + 1 bits per column: bit col * (ROWS + 1) + h
+// is the cell h rows above the bottom. The spare top bit of each column stays empty so
+// that shifted line patterns never wrap into the next column.
+#define BITBOARD_BIT(row, col) ((uint64_t)1 << ((col) * (ROWS + 1) + (ROWS - 1 - (row))))
+void board_to_bitboards(int board[ROWS][COLS], uint64_t pieces[2]); // pieces[player - 1]
+uint64_t bitboard_playable(uint64_t occupied);                   // Lowest empty cell of each open column
+uint64_t bitboard_winning_cells(uint64_t own, uint64_t occupied); // Empty cells that would complete a line for own
+
 #endif // CONNECTFOUR_H
@@ -16,12 +16,17 @@
 // --- MCTS Constants ---
 #define MCTS_ITERATIONS 10000 // Key parameter for AI strength. Increase for stronger AI (but longer thinking time).
 #define UCB_C 1.414         // Exploration constant (sqrt(2) is common)
+#define MCTS_USE_RAVE false   // Blend all-moves-as-first (AMAF) statistics into selection by default
+#define RAVE_K 50.0           // RAVE equivalence parameter: visits at which UCB and AMAF values weigh equally
+#define RAVE_UCB_C 0.2        // Exploration constant when RAVE is on (AMAF already spreads early visits)
+#define MCTS_PLAYOUT_POLICY PLAYOUT_RANDOM // Default playout policy (see PlayoutPolicy in mcts.h)
 
 // --- MCTS Node Structure ---
 typedef struct MCTSNode {
     int board[ROWS][COLS];
     int player; // Player whose turn it is *at this node*
     int move;   // The move (column) that led to this state (-1 for root)
+    int move_row; // Row the move's piece landed in (-1 for root)
 
     struct MCTSNode *parent;
     struct MCTSNode *children[COLS]; // Max COLS possible moves
@@ -30,6 +35,11 @@ typedef struct MCTSNode {
     int wins;   // Number of wins from simulations passing through this node
     int visits; // Number of times this node was visited
 
+    // AMAF statistics: simulations in which the player at the parent occupied this
+    // node's cell at any later point, not only as the immediate move (used by RAVE)
+    int amaf_wins;
+    int amaf_visits;
+
     int untried_moves[COLS]; // Columns not yet explored from this node
     int num_untried_moves;
 
@@ -2,10 +2,14 @@
 #include <stdlib.h>
 #include <time.h>   // For srand
 #include <limits.h> // For INT_MAX
+#include <string.h> // For strcmp, strcspn
+#include <unistd.h> // For sysconf
 
 #include "defines.h"
 #include "connectfour.h"
 #include "mcts.h"
+#include "analysis.h"
+#include "bench.h"
 
 // Helper to get integer input safely
 int get_int_input(const char* prompt) {
@@ -38,14 +42,132 @@ int get_int_input(const char* prompt) {
 }
 
 
-int main() {
-    int board[ROWS][COLS];
-    bool game_over = false;
-    int turn = PLAYER1; // Player 1 starts
+static void print_usage(const char* program) {
+    fprintf(stderr,
+            "Usage: %s                      Play against the AI\n"
+            "       %s --analyze [FILE]     Analyze positions from FILE (or stdin), one move string per line\n"
+            "       %s --bench              Compare random and tactical playout policies\n"
+            "Analysis options:\n"
+            "  --threads N      Worker threads (default: number of online CPUs)\n"
+            "  --iterations N   MCTS iterations per position (default: %d)\n"
+            "  --rave           Blend all-moves-as-first statistics into selection (RAVE)\n"
+            "  --tactical       Playouts take immediate wins and block immediate losses\n"
+            "Benchmark options:\n"
+            "  --games N        Self-play games per strength match (default: %d)\n"
+            "  --move-ms N      Nominal CPU milliseconds per move used to size searches (default: %d)\n"
+            "  --rave           Use RAVE for both sides\n",
+            program, program, program, MCTS_ITERATIONS, BENCH_DEFAULT_GAMES, BENCH_DEFAULT_MOVE_MS);
+}
+
+// Parses a strictly positive integer option value
+static bool parse_positive_int(const char* text, int* value) {
+    char* endptr;
+    long parsed = strtol(text, &endptr, 10);
+    if (endptr == text || *endptr != '\0' || parsed < 1 || parsed > INT_MAX) {
+        return false;
+    }
+    *value = (int)parsed;
+    return true;
+}
+
+// --analyze mode: batch analysis for offline jobs
+static int run_analysis(int argc, char* argv[]) {
+    const char* input_path = NULL;
+    long online_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int num_threads = online_cpus > 0 ? (int)online_cpus : 1;
+    MCTSOptions options;
+    mcts_default_options(&options);
+
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            if (!parse_positive_int(argv[++i], &num_threads)) {
+                fprintf(stderr, "Invalid thread count: %s\n", argv[i]);
+                return EXIT_FAILURE;
+            }
+        } else if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            if (!parse_positive_int(argv[++i], &options.iterations)) {
+                fprintf(stderr, "Invalid iteration count: %s\n", argv[i]);
+                return EXIT_FAILURE;
+            }
+        } else if (strcmp(argv[i], "--rave") == 0) {
+            options.use_rave = true;
+        } else if (strcmp(argv[i], "--tactical") == 0) {
+            options.playout_policy = PLAYOUT_TACTICAL;
+        } else if (argv[i][0] != '-' && input_path == NULL) {
+            input_path = argv[i];
+        } else if (strcmp(argv[i], "-") == 0 && input_path == NULL) {
+            input_path = argv[i]; // Explicit stdin
+        } else {
+            print_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    FILE* in = stdin;
+    if (input_path != NULL && strcmp(input_path, "-") != 0) {
+        in = fopen(input_path, "r");
+        if (!in) {
+            perror(input_path);
+            return EXIT_FAILURE;
+        }
+    }
+
+    long analyzed = analyze_stream(in, stdout, num_threads, &options);
+
+    if (in != stdin) fclose(in);
+    return analyzed < 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+// --bench mode: playout policy throughput and strength per CPU-second
+static int run_benchmark(int argc, char* argv[]) {
+    int num_games = BENCH_DEFAULT_GAMES;
+    int move_ms = BENCH_DEFAULT_MOVE_MS;
+    MCTSOptions options;
+    mcts_default_options(&options);
+
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--games") == 0 && i + 1 < argc) {
+            if (!parse_positive_int(argv[++i], &num_games)) {
+                fprintf(stderr, "Invalid game count: %s\n", argv[i]);
+                return EXIT_FAILURE;
+            }
+        } else if (strcmp(argv[i], "--move-ms") == 0 && i + 1 < argc) {
+            if (!parse_positive_int(argv[++i], &move_ms)) {
+                fprintf(stderr, "Invalid move time: %s\n", argv[i]);
+                return EXIT_FAILURE;
+            }
+        } else if (strcmp(argv[i], "--rave") == 0) {
+            options.use_rave = true;
+        } else {
+            print_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    run_playout_benchmark(stdout, &options, num_games, move_ms / 1000.0);
+    return EXIT_SUCCESS;
+}
 
+
+int main(int argc, char* argv[]) {
     // Seed random number generator ONCE
     srand(time(NULL));
 
+    if (argc > 1) {
+        if (strcmp(argv[1], "--analyze") == 0) {
+            return run_analysis(argc, argv);
+        }
+        if (strcmp(argv[1], "--bench") == 0) {
+            return run_benchmark(argc, argv);
+        }
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    int board[ROWS][COLS];
+    bool game_over = false;
+    int turn = PLAYER1; // Player 1 starts
+
     init_board(board);
     print_board(board);
 
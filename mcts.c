@@ -8,6 +8,43 @@
 #include <time.h>   // For rand() seeding
 
 
+// --- Random Number Generation ---
+// rand() shares one global state behind a lock, which serializes concurrent searches.
+// Each thread gets its own xorshift32 state instead, seeded from rand() on first use
+// so that srand() in main() still controls the interactive game.
+static _Thread_local unsigned int rng_state = 0;
+
+void mcts_seed(unsigned int seed) {
+    rng_state = seed ? seed : 0x9E3779B9u; // xorshift state must be non-zero
+}
+
+int mcts_rand(void) {
+    if (rng_state == 0) {
+        mcts_seed((unsigned int)rand() * 2654435761u + 1u);
+    }
+    unsigned int x = rng_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    rng_state = x;
+    return (int)(x >> 1); // Non-negative, like rand()
+}
+
+void mcts_default_options(MCTSOptions* options) {
+    options->iterations = MCTS_ITERATIONS;
+    options->use_rave = MCTS_USE_RAVE;
+    options->playout_policy = MCTS_PLAYOUT_POLICY;
+}
+
+void mcts_clear_result(MCTSResult* result) {
+    result->best_move = -1;
+    result->value = 0.0;
+    for (int c = 0; c < COLS; c++) {
+        result->visits[c] = 0;
+    }
+}
+
+
 MCTSNode* create_node(MCTSNode* parent, int move, int board[ROWS][COLS], int player) {
     MCTSNode* node = (MCTSNode*)malloc(sizeof(MCTSNode));
     if (!node) {
@@ -18,10 +55,13 @@ MCTSNode* create_node(MCTSNode* parent, int move, int board[ROWS][COLS], int pla
     copy_board(node->board, board);
     node->player = player;
     node->move = move;
+    node->move_row = -1; // Set by expand_node, which knows where the piece landed
     node->parent = parent;
     node->num_children = 0;
     node->wins = 0;
     node->visits = 0;
+    node->amaf_wins = 0;
+    node->amaf_visits = 0;
 
     // Initialize children pointers to NULL
     for (int i = 0; i < COLS; ++i) {
@@ -76,8 +116,28 @@ double ucb1(MCTSNode* node) {
            UCB_C * sqrt(log((double)node->parent->visits) / node->visits);
 }
 
+// --- RAVE Calculation ---
+// Blends the node's own win rate with its AMAF win rate. The AMAF weight
+// beta = sqrt(RAVE_K / (3n + RAVE_K)) starts at 1 and decays as real visits n
+// accumulate, reaching 1/2 at n = RAVE_K.
+double rave_score(MCTSNode* node) {
+    if (node->visits == 0) {
+        return DBL_MAX; // Prioritize unvisited nodes, as in ucb1()
+    }
+    double q = (double)node->wins / node->visits;
+    if (node->amaf_visits > 0) {
+        double amaf_q = (double)node->amaf_wins / node->amaf_visits;
+        double beta = sqrt(RAVE_K / (3.0 * node->visits + RAVE_K));
+        q = (1.0 - beta) * q + beta * amaf_q;
+    }
+    if (node->parent == NULL || node->parent->visits == 0) {
+        return q;
+    }
+    return q + RAVE_UCB_C * sqrt(log((double)node->parent->visits) / node->visits);
+}
+
 // --- Selection Phase ---
-MCTSNode* select_node(MCTSNode* node) {
+MCTSNode* select_node(MCTSNode* node, const MCTSOptions* options) {
     while (!node->is_terminal) {
         if (node->num_untried_moves > 0) {
             return expand_node(node); // If node has untried moves, expand it
@@ -88,13 +148,14 @@ MCTSNode* select_node(MCTSNode* node) {
              return node;
         }
 
-        // Select best child using UCB1
+        // Select best child using UCB1, or the RAVE-blended score when enabled
         MCTSNode* best_child = NULL;
         double best_score = -1.0;
 
         for (int i = 0; i < node->num_children; i++) {
             if(node->children[i]) { // Ensure child pointer is valid
-                double score = ucb1(node->children[i]);
+                double score = options->use_rave ? rave_score(node->children[i])
+                                                 : ucb1(node->children[i]);
                 if (score > best_score) {
                     best_score = score;
                     best_child = node->children[i];
@@ -120,7 +181,7 @@ MCTSNode* expand_node(MCTSNode* node) {
     }
 
     // Select an untried move randomly
-    int move_index = rand() % node->num_untried_moves;
+    int move_index = mcts_rand() % node->num_untried_moves;
     int move_col = node->untried_moves[move_index];
 
     // Create the board state for the new child
@@ -145,6 +206,7 @@ MCTSNode* expand_node(MCTSNode* node) {
         // Allocation failed
         return node; // Can't expand
     }
+    new_child->move_row = row;
 
     // Add the new child to the parent's children list
     // Find the first NULL spot, should correspond to num_children index
@@ -167,7 +229,7 @@ MCTSNode* expand_node(MCTSNode* node) {
 }
 
 // --- Simulation Phase (Random Playout) ---
-int simulate_random_playout(MCTSNode* node) {
+int simulate_random_playout(MCTSNode* node, uint64_t played_cells[2]) {
     int temp_board[ROWS][COLS];
     copy_board(temp_board, node->board);
     int current_player = node->player;
@@ -187,12 +249,15 @@ int simulate_random_playout(MCTSNode* node) {
         }
 
         // Choose a random valid move
-        int random_move_col = valid_moves[rand() % num_valid_moves];
+        int random_move_col = valid_moves[mcts_rand() % num_valid_moves];
         free(valid_moves); // Free the list after use
 
         int row = get_next_open_row(temp_board, random_move_col);
         if (row != -1) {
              drop_piece(temp_board, row, random_move_col, current_player);
+             if (played_cells) {
+                 played_cells[current_player - 1] |= BITBOARD_BIT(row, random_move_col);
+             }
         } else {
             fprintf(stderr, "Error during simulation: get_next_open_row failed for valid move.\n");
              // This indicates a potential logic error elsewhere
@@ -212,8 +277,86 @@ int simulate_random_playout(MCTSNode* node) {
 }
 
 
+// --- Simulation Phase (Bitboard Playouts) ---
+// Picks a uniformly random set bit of a non-empty bitboard
+static uint64_t random_bit(uint64_t bits) {
+    int pick = mcts_rand() % __builtin_popcountll(bits);
+    while (pick-- > 0) {
+        bits &= bits - 1; // Clear lowest set bit
+    }
+    return bits & -bits;
+}
+
+// Shared by the uniform and tactical policies so that they differ only in move choice
+static int simulate_bitboard_playout(MCTSNode* node, uint64_t played_cells[2], bool tactical) {
+    if (node->terminal_winner != -1) {
+        return node->terminal_winner;
+    }
+
+    uint64_t start[2];
+    uint64_t pieces[2];
+    board_to_bitboards(node->board, start);
+    pieces[0] = start[0];
+    pieces[1] = start[1];
+    int current_player = node->player;
+    int winner = 0;
+
+    // Neither side can have a completed line on entry (non-terminal), and a move only
+    // completes one if it lands on one of the mover's winning cells, so checking that
+    // replaces a full check_win() scan.
+    while (true) {
+        uint64_t own = pieces[current_player - 1];
+        uint64_t opponent = pieces[2 - current_player];
+        uint64_t occupied = own | opponent;
+        uint64_t playable = bitboard_playable(occupied);
+        if (playable == 0) {
+            break; // Board full: draw
+        }
+
+        uint64_t wins = bitboard_winning_cells(own, occupied) & playable;
+        uint64_t move;
+        if (!tactical) {
+            move = random_bit(playable);
+        } else if (wins) {
+            move = wins & -wins; // Take the win
+        } else {
+            uint64_t blocks = bitboard_winning_cells(opponent, occupied) & playable;
+            move = random_bit(blocks ? blocks : playable);
+        }
+        pieces[current_player - 1] |= move;
+        if (move & wins) {
+            winner = current_player;
+            break;
+        }
+
+        current_player = (current_player == PLAYER1) ? PLAYER2 : PLAYER1;
+    }
+
+    if (played_cells) {
+        played_cells[0] |= pieces[0] & ~start[0];
+        played_cells[1] |= pieces[1] & ~start[1];
+    }
+    return winner;
+}
+
+int simulate_bitboard_random_playout(MCTSNode* node, uint64_t played_cells[2]) {
+    return simulate_bitboard_playout(node, played_cells, false);
+}
+
+int simulate_tactical_playout(MCTSNode* node, uint64_t played_cells[2]) {
+    return simulate_bitboard_playout(node, played_cells, true);
+}
+
+
 // --- Backpropagation Phase ---
-void backpropagate(MCTSNode* node, int simulation_winner) {
+void backpropagate(MCTSNode* node, int simulation_winner, const uint64_t played_cells[2]) {
+    // Cells each player filled from the current node downwards (playout + tree path)
+    uint64_t played[2] = { 0, 0 };
+    if (played_cells) {
+        played[0] = played_cells[0];
+        played[1] = played_cells[1];
+    }
+
     MCTSNode* current_node = node;
     while (current_node != NULL) {
         current_node->visits++;
@@ -235,15 +378,37 @@ void backpropagate(MCTSNode* node, int simulation_winner) {
          // Alternative: Could give 0.5 wins for a draw, but standard MCTS often just increments visits.
          // if (simulation_winner == 0) { current_node->wins += 0.5; } // Requires changing wins to double
 
+        if (played_cells) {
+            // AMAF: credit every child whose cell the player to move here went on to fill,
+            // as if that move had been played first
+            uint64_t mover_cells = played[current_node->player - 1];
+            for (int i = 0; i < current_node->num_children; i++) {
+                MCTSNode* child = current_node->children[i];
+                if (child && (mover_cells & BITBOARD_BIT(child->move_row, child->move))) {
+                    child->amaf_visits++;
+                    if (simulation_winner == current_node->player) {
+                        child->amaf_wins++;
+                    }
+                }
+            }
+            // The move into this node belongs to the parent's player
+            if (current_node->parent) {
+                played[current_node->parent->player - 1] |=
+                    BITBOARD_BIT(current_node->move_row, current_node->move);
+            }
+        }
+
         current_node = current_node->parent;
     }
 }
 
 
 // --- Main MCTS Function ---
-int mcts_get_best_move(int current_board[ROWS][COLS], int current_player) {
-    // Seed random number generator if not already done globally
-    // srand(time(NULL)); // Consider seeding once in main()
+int mcts_analyze(int current_board[ROWS][COLS], int current_player,
+                 const MCTSOptions* options, MCTSResult* result) {
+    if (result) {
+        mcts_clear_result(result);
+    }
 
     MCTSNode* root = create_node(NULL, -1, current_board, current_player);
     if (!root) return -1; // Error creating root
@@ -260,39 +425,43 @@ int mcts_get_best_move(int current_board[ROWS][COLS], int current_player) {
     }
 
 
-    for (int i = 0; i < MCTS_ITERATIONS; i++) {
+    for (int i = 0; i < options->iterations; i++) {
         // 1. Selection
-        MCTSNode* leaf = select_node(root);
+        MCTSNode* leaf = select_node(root, options);
 
         // 2. Simulation (if selection didn't end on a terminal node already expanded)
         // Note: select_node already calls expand_node if appropriate.
         // 'leaf' might be the newly expanded node or a terminal node.
-        int simulation_result = simulate_random_playout(leaf);
+        // With RAVE on, also record which cells each side filled for the AMAF update.
+        uint64_t played_cells[2] = { 0, 0 };
+        uint64_t* trace = options->use_rave ? played_cells : NULL;
+        int simulation_result;
+        switch (options->playout_policy) {
+            case PLAYOUT_BITBOARD_RANDOM:
+                simulation_result = simulate_bitboard_random_playout(leaf, trace);
+                break;
+            case PLAYOUT_TACTICAL:
+                simulation_result = simulate_tactical_playout(leaf, trace);
+                break;
+            default:
+                simulation_result = simulate_random_playout(leaf, trace);
+                break;
+        }
 
         // 3. Backpropagation
-        backpropagate(leaf, simulation_result);
-
-        // Optional: Print progress
-        // if ((i + 1) % (MCTS_ITERATIONS / 10) == 0) {
-        //     printf("MCTS Iteration %d/%d\n", i + 1, MCTS_ITERATIONS);
-        // }
+        backpropagate(leaf, simulation_result, trace);
     }
 
     // Choose the best move based on the most visited child of the root
     MCTSNode* best_child = NULL;
     int most_visits = -1;
 
-    //printf("\nMCTS Root Node Analysis:\n"); // Debug
-    //printf("Root Visits: %d\n", root->visits);
-
     for (int i = 0; i < root->num_children; i++) {
         MCTSNode* child = root->children[i];
         if (child) {
-             // Debug print:
-             //printf("  Child Move: %d, Wins: %d, Visits: %d, Win Rate: %.2f%%\n",
-             //       child->move, child->wins, child->visits,
-             //       child->visits > 0 ? 100.0 * child->wins / child->visits : 0.0);
-
+            if (result) {
+                result->visits[child->move] = child->visits;
+            }
             if (child->visits > most_visits) {
                 most_visits = child->visits;
                 best_child = child;
@@ -303,12 +472,15 @@ int mcts_get_best_move(int current_board[ROWS][COLS], int current_player) {
     int best_move = -1;
     if (best_child != NULL) {
         best_move = best_child->move;
-         //printf("Chosen Move: %d (Visits: %d)\n", best_move, most_visits);
+        // child->wins counts wins for the player who moved into the child, i.e. the side to move at root
+        if (result && best_child->visits > 0) {
+            result->value = (double)best_child->wins / best_child->visits;
+        }
     } else if (root->num_untried_moves > 0) {
         // Fallback: If somehow no children were explored (e.g., low iterations),
         // pick a random untried move. Should be rare with sufficient iterations.
         fprintf(stderr, "Warning: No children explored, picking random untried move.\n");
-        best_move = root->untried_moves[rand() % root->num_untried_moves];
+        best_move = root->untried_moves[mcts_rand() % root->num_untried_moves];
     } else {
          fprintf(stderr, "Error: MCTS could not determine a best move.\n");
          // Maybe pick the first valid move?
@@ -318,9 +490,21 @@ int mcts_get_best_move(int current_board[ROWS][COLS], int current_player) {
          if(valid) free(valid);
     }
 
+    if (result) {
+        result->best_move = best_move;
+    }
 
     // Clean up the MCTS tree
     free_node(root);
 
     return best_move;
 }
+
+int mcts_get_best_move(int current_board[ROWS][COLS], int current_player) {
+    // Seed random number generator if not already done globally
+    // srand(time(NULL)); // Consider seeding once in main()
+
+    MCTSOptions options;
+    mcts_default_options(&options);
+    return mcts_analyze(current_board, current_player, &options, NULL);
+}
@@ -3,15 +3,54 @@
 
 #include "defines.h"
 #include "connectfour.h" // Include connect4 for game logic functions
+#include <stdint.h>
+
+// --- Playout Policies ---
+typedef enum {
+    PLAYOUT_RANDOM,          // simulate_random_playout: uniform moves on the int board
+    PLAYOUT_BITBOARD_RANDOM, // simulate_bitboard_random_playout: uniform moves on bitboards
+    PLAYOUT_TACTICAL         // simulate_tactical_playout: win, else block, else uniform, on bitboards
+} PlayoutPolicy;
+
+// --- MCTS Search Options ---
+typedef struct MCTSOptions {
+    int iterations; // Number of select/expand/simulate/backpropagate rounds per search
+    bool use_rave;  // Blend AMAF statistics into child selection (RAVE)
+    PlayoutPolicy playout_policy; // How leaf positions are simulated
+} MCTSOptions;
+
+// --- MCTS Search Result ---
+typedef struct MCTSResult {
+    int best_move;     // Chosen column (most visited root child), -1 if none
+    double value;      // Win rate of best_move for the side to move (0.0 - 1.0)
+    int visits[COLS];  // Root child visit count per column (0 if unexplored or illegal)
+} MCTSResult;
 
 // --- MCTS Function Declarations ---
 
+void mcts_default_options(MCTSOptions* options);
+void mcts_clear_result(MCTSResult* result); // No move, zero value, zero visits
+void mcts_seed(unsigned int seed); // Seeds the calling thread's RNG (auto-seeded from rand() otherwise)
+int mcts_rand(void);               // Thread-local PRNG used by the search, safe to call from worker threads
+
 MCTSNode* create_node(MCTSNode* parent, int move, int board[ROWS][COLS], int player);
 void free_node(MCTSNode* node); // Recursively frees node and its children
-MCTSNode* select_node(MCTSNode* node);
+MCTSNode* select_node(MCTSNode* node, const MCTSOptions* options);
 MCTSNode* expand_node(MCTSNode* node);
-int simulate_random_playout(MCTSNode* node); // Returns winner (PLAYER1/PLAYER2) or 0 for draw
-void backpropagate(MCTSNode* node, int simulation_winner);
+// Returns winner (PLAYER1/PLAYER2) or 0 for draw. If played_cells is non-NULL, the cells
+// each player filled during the playout are OR-ed into played_cells[player - 1], as
+// BITBOARD_BIT(row, col) masks.
+int simulate_random_playout(MCTSNode* node, uint64_t played_cells[2]);
+// Same contract and move distribution, but runs on bitboards. This is the control for
+// simulate_tactical_playout: the two differ only in move choice.
+int simulate_bitboard_random_playout(MCTSNode* node, uint64_t played_cells[2]);
+// Same contract, but each side plays an immediate win if it has one, otherwise blocks
+// the opponent's immediate win, otherwise moves at random. Runs on bitboards.
+int simulate_tactical_playout(MCTSNode* node, uint64_t played_cells[2]);
+// played_cells may be NULL; otherwise AMAF statistics are updated along the path as well.
+void backpropagate(MCTSNode* node, int simulation_winner, const uint64_t played_cells[2]);
+int mcts_analyze(int current_board[ROWS][COLS], int current_player,
+                 const MCTSOptions* options, MCTSResult* result); // Returns best move, fills result if non-NULL
 int mcts_get_best_move(int current_board[ROWS][COLS], int current_player);
 
 #endif // MCTS_H
@@ -0,0 +1,275 @@
+#include "threadpool.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+#define DEQUE_INITIAL_CAPACITY 64 // Must be a power of two (grows by doubling)
+
+typedef struct {
+    ThreadPoolTask task;
+    void* arg;
+} WorkItem;
+
+// --- Per-Worker Deque ---
+// Owner pushes at the tail; owner and thieves alike take from the head, so tasks
+// run oldest-first. Callers that consume results in submission order (e.g.
+// analyze_stream) would otherwise wait on the task its worker runs last.
+typedef struct {
+    WorkItem* items;
+    size_t capacity; // Power of two, so indices wrap with a mask
+    size_t head;     // Oldest item, next to be taken
+    size_t tail;     // One past the most recently pushed item
+    pthread_mutex_t lock;
+} WorkDeque;
+
+struct ThreadPool {
+    pthread_t* threads;
+    WorkDeque* deques;
+    int num_threads;
+
+    pthread_mutex_t lock;
+    pthread_cond_t work_available; // Signalled when a task is queued or on shutdown
+    pthread_cond_t all_done;       // Signalled when pending drops to zero
+    int queued;                    // Tasks sitting in deques, not yet taken by a worker
+    int pending;                   // Tasks submitted but not yet finished
+    int next_deque;                // Round-robin target for external submissions
+    bool shutdown;
+};
+
+typedef struct {
+    ThreadPool* pool;
+    int index;
+} WorkerArgs;
+
+// Lets threadpool_submit() called from inside a task push onto the caller's own deque
+static _Thread_local ThreadPool* current_pool = NULL;
+static _Thread_local int current_worker = -1;
+
+
+// --- Deque Operations ---
+static bool deque_init(WorkDeque* deque) {
+    deque->items = (WorkItem*)malloc(DEQUE_INITIAL_CAPACITY * sizeof(WorkItem));
+    if (!deque->items) {
+        perror("Failed to allocate work deque");
+        return false;
+    }
+    deque->capacity = DEQUE_INITIAL_CAPACITY;
+    deque->head = 0;
+    deque->tail = 0;
+    pthread_mutex_init(&deque->lock, NULL);
+    return true;
+}
+
+static void deque_destroy(WorkDeque* deque) {
+    pthread_mutex_destroy(&deque->lock);
+    free(deque->items);
+}
+
+static bool deque_push(WorkDeque* deque, WorkItem item) {
+    pthread_mutex_lock(&deque->lock);
+    if (deque->tail - deque->head == deque->capacity) {
+        // Full: copy into a buffer twice the size, unwrapping the ring
+        size_t new_capacity = deque->capacity * 2;
+        WorkItem* grown = (WorkItem*)malloc(new_capacity * sizeof(WorkItem));
+        if (!grown) {
+            pthread_mutex_unlock(&deque->lock);
+            perror("Failed to grow work deque");
+            return false;
+        }
+        for (size_t i = deque->head; i != deque->tail; i++) {
+            grown[i & (new_capacity - 1)] = deque->items[i & (deque->capacity - 1)];
+        }
+        free(deque->items);
+        deque->items = grown;
+        deque->capacity = new_capacity;
+    }
+    deque->items[deque->tail & (deque->capacity - 1)] = item;
+    deque->tail++;
+    pthread_mutex_unlock(&deque->lock);
+    return true;
+}
+
+static bool deque_take(WorkDeque* deque, WorkItem* item) {
+    bool found = false;
+    pthread_mutex_lock(&deque->lock);
+    if (deque->tail != deque->head) {
+        *item = deque->items[deque->head & (deque->capacity - 1)];
+        deque->head++;
+        found = true;
+    }
+    pthread_mutex_unlock(&deque->lock);
+    return found;
+}
+
+
+// --- Worker Loop ---
+static bool take_task(ThreadPool* pool, int index, WorkItem* item) {
+    if (deque_take(&pool->deques[index], item)) {
+        return true;
+    }
+    // Own deque is empty: try to steal, starting with the next worker over
+    for (int i = 1; i < pool->num_threads; i++) {
+        if (deque_take(&pool->deques[(index + i) % pool->num_threads], item)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void* worker_main(void* arg) {
+    WorkerArgs* args = (WorkerArgs*)arg;
+    ThreadPool* pool = args->pool;
+    int index = args->index;
+    free(args);
+
+    current_pool = pool;
+    current_worker = index;
+
+    while (true) {
+        WorkItem item;
+        if (take_task(pool, index, &item)) {
+            pthread_mutex_lock(&pool->lock);
+            pool->queued--;
+            pthread_mutex_unlock(&pool->lock);
+
+            item.task(item.arg);
+
+            pthread_mutex_lock(&pool->lock);
+            pool->pending--;
+            if (pool->pending == 0) {
+                pthread_cond_broadcast(&pool->all_done);
+            }
+            pthread_mutex_unlock(&pool->lock);
+            continue;
+        }
+
+        // Nothing to run or steal: sleep until new work arrives
+        pthread_mutex_lock(&pool->lock);
+        while (pool->queued == 0 && !pool->shutdown) {
+            pthread_cond_wait(&pool->work_available, &pool->lock);
+        }
+        bool exit_worker = pool->shutdown && pool->queued == 0;
+        pthread_mutex_unlock(&pool->lock);
+        if (exit_worker) break;
+    }
+    return NULL;
+}
+
+
+// --- Setup / Teardown ---
+// Stops and joins the first num_started workers, then frees everything.
+static void pool_teardown(ThreadPool* pool, int num_started, int num_deques) {
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = true;
+    pthread_cond_broadcast(&pool->work_available);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int i = 0; i < num_started; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+    for (int i = 0; i < num_deques; i++) {
+        deque_destroy(&pool->deques[i]);
+    }
+    pthread_cond_destroy(&pool->all_done);
+    pthread_cond_destroy(&pool->work_available);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->deques);
+    free(pool->threads);
+    free(pool);
+}
+
+
+// --- Public API ---
+ThreadPool* threadpool_create(int num_threads) {
+    if (num_threads < 1) num_threads = 1;
+
+    ThreadPool* pool = (ThreadPool*)calloc(1, sizeof(ThreadPool));
+    if (!pool) {
+        perror("Failed to allocate thread pool");
+        return NULL;
+    }
+    pool->threads = (pthread_t*)calloc(num_threads, sizeof(pthread_t));
+    pool->deques = (WorkDeque*)calloc(num_threads, sizeof(WorkDeque));
+    if (!pool->threads || !pool->deques) {
+        perror("Failed to allocate thread pool workers");
+        free(pool->threads);
+        free(pool->deques);
+        free(pool);
+        return NULL;
+    }
+    pool->num_threads = num_threads;
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_available, NULL);
+    pthread_cond_init(&pool->all_done, NULL);
+
+    for (int i = 0; i < num_threads; i++) {
+        if (!deque_init(&pool->deques[i])) {
+            pool_teardown(pool, 0, i);
+            return NULL;
+        }
+    }
+
+    for (int i = 0; i < num_threads; i++) {
+        WorkerArgs* args = (WorkerArgs*)malloc(sizeof(WorkerArgs));
+        if (args) {
+            args->pool = pool;
+            args->index = i;
+        }
+        if (!args || pthread_create(&pool->threads[i], NULL, worker_main, args) != 0) {
+            fprintf(stderr, "Error: Failed to start worker thread %d.\n", i);
+            free(args);
+            pool_teardown(pool, i, num_threads);
+            return NULL;
+        }
+    }
+
+    return pool;
+}
+
+bool threadpool_submit(ThreadPool* pool, ThreadPoolTask task, void* arg) {
+    WorkItem item = { task, arg };
+
+    // Count the task before it becomes visible so a worker can never finish it
+    // ahead of the bookkeeping.
+    pthread_mutex_lock(&pool->lock);
+    int target;
+    if (current_pool == pool) {
+        target = current_worker;
+    } else {
+        target = pool->next_deque;
+        pool->next_deque = (pool->next_deque + 1) % pool->num_threads;
+    }
+    pool->queued++;
+    pool->pending++;
+    pthread_mutex_unlock(&pool->lock);
+
+    bool pushed = deque_push(&pool->deques[target], item);
+
+    pthread_mutex_lock(&pool->lock);
+    if (pushed) {
+        pthread_cond_signal(&pool->work_available);
+    } else {
+        pool->queued--;
+        pool->pending--;
+        if (pool->pending == 0) {
+            pthread_cond_broadcast(&pool->all_done);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return pushed;
+}
+
+void threadpool_wait(ThreadPool* pool) {
+    pthread_mutex_lock(&pool->lock);
+    while (pool->pending > 0) {
+        pthread_cond_wait(&pool->all_done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+void threadpool_destroy(ThreadPool* pool) {
+    if (!pool) return;
+    threadpool_wait(pool);
+    pool_teardown(pool, pool->num_threads, pool->num_threads);
+}
@@ -0,0 +1,21 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <stdbool.h>
+
+// --- Work-Stealing Thread Pool ---
+// Each worker owns a deque: it runs its own tasks oldest-first and, when empty,
+// steals the oldest task from the other workers. Tasks submitted from outside the
+// pool are dealt round-robin; tasks submitted from a worker go to that worker's
+// own deque.
+
+typedef void (*ThreadPoolTask)(void* arg);
+
+typedef struct ThreadPool ThreadPool;
+
+ThreadPool* threadpool_create(int num_threads); // Returns NULL on failure
+bool threadpool_submit(ThreadPool* pool, ThreadPoolTask task, void* arg);
+void threadpool_wait(ThreadPool* pool);         // Blocks until every submitted task has finished
+void threadpool_destroy(ThreadPool* pool);      // Waits for outstanding tasks, then joins workers
+
+#endif // THREADPOOL_H